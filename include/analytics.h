@@ -0,0 +1,43 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+
+/// @brief Difficulty metrics of a board, derived from its mines and adjacent mine counts only.
+///        Mine density is measured over `REGION_SIZE` x `REGION_SIZE` regions stepping across the board. Where the board
+///        is not a multiple of the region size (its 25 columns), the last region ends at the board edge and overlaps
+///        its neighbour, so every region has the same number of tiles.
+struct BoardStats
+{
+    static constexpr unsigned int REGION_SIZE = 8; // Side of the square regions used for mine density
+
+    unsigned int mines;           // Total number of mines
+    unsigned int threeBV;         // Minimum left clicks to clear the board without flags (standard 3BV)
+    unsigned int openings;        // Connected regions of tiles with no adjacent mines
+    unsigned int largestOpening;  // Tiles with no adjacent mines in the largest opening
+    unsigned int isolatedNumbers; // Numbered tiles that do not border an opening
+    float minRegionDensity;       // Mine density of the least mined region
+    float maxRegionDensity;       // Mine density of the most mined region
+};
+
+/// @brief Compute the metrics of a board in one pass over its tiles, joining openings with a union-find.
+/// @param tiles The tiles of the board, stored row by row as returned by `Board::generateTiles`.
+/// @return The metrics of the board.
+BoardStats analyzeBoard(const std::vector<Tile> &tiles);
+
+/// @brief Run the batch analysis mode and write one CSV row per board to `out`.
+///
+///        Arguments: `[--boards <count>] [--mines <count>] [--seed <seed>] [--threads <count>] [files...]`.
+///        Board files are analyzed if any are given; otherwise `count` boards (default 1000) are generated
+///        from `seed` (default from the clock), one game index per board. Boards are analyzed on all cores
+///        without building sprites, and rows are written in order, one batch at a time.
+/// @param args The command-line arguments after the mode flag.
+/// @param out The stream the CSV is written to.
+/// @return The process exit code.
+int runAnalytics(const std::vector<std::string> &args, std::ostream &out);
+
+#endif // ANALYTICS_H
@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <cstdint>
 #include <stack>
 
 #include "textures.h"
@@ -18,21 +19,37 @@
 class Board
 {
 public:
-    static constexpr unsigned int WIDTH = 25;    // The width of the board
-    static constexpr unsigned int HEIGHT = 16;   // The height of the board
-    static constexpr unsigned int NUM_TESTS = 3; // Number of test buttons for the board
+    static constexpr unsigned int WIDTH = 25;       // The width of the board
+    static constexpr unsigned int HEIGHT = 16;      // The height of the board
+    static constexpr unsigned int NUM_TESTS = 3;    // Number of test buttons for the board
+    static constexpr std::uint64_t MINE_STREAM = 0; // Random stream used for mine placement
 
     /* ------------------------------ Constructors ------------------------------ */
 
-    /// @brief Construct a Board object with randomly placed `mines. Default 50
+    /// @brief Construct a Board object with randomly placed `mines`. Default 50
+    ///        The same `mines`, `seed` and `game` always produce the same board.
     /// @param mines The number of mines on the board.
-    Board(unsigned int mines = 50);
+    /// @param seed The seed of the mine placement. Default a new seed from the clock.
+    /// @param game The index of the game within `seed`, to generate many boards from one seed.
+    Board(unsigned int mines = 50, std::uint64_t seed = Random::timeSeed(), std::uint64_t game = 0);
 
     /// @brief Construct a Board object from a text file comprised of a
     ///        16 x 25 grid of zeros (normal tiles) and ones (mines).
     /// @param file The path to the text file.
     Board(const std::string &file);
 
+    /* ------------------------------- Generation ------------------------------- */
+
+    /// @brief Place the mines of `Board(mines, seed, game)` and count adjacent mines, without building any sprites.
+    /// @return The hidden tiles of the board, stored row by row (index = row * WIDTH + col).
+    /// @throws std::runtime_error if `mines` exceeds the number of tiles.
+    static std::vector<Tile> generateTiles(unsigned int mines, std::uint64_t seed, std::uint64_t game = 0);
+
+    /// @brief Read the mines of `Board(file)` and count adjacent mines, without building any sprites.
+    /// @return The hidden tiles of the board, stored row by row (index = row * WIDTH + col).
+    /// @throws std::runtime_error if the file cannot be opened or is not a 16 x 25 grid.
+    static std::vector<Tile> loadTiles(const std::string &file);
+
     /* -------------------------------- Accessors ------------------------------- */
 
     /// @return The face button sprite.
@@ -45,14 +62,59 @@ public:
     /// @return The debug button sprite.
     const sf::Sprite &getDebugButton() const;
 
+    /// @return The hint button sprite.
+    const sf::Sprite &getHintButton() const;
+
     /// @return The current face type (Lose/Win/Playable).
     int getFace() const;
 
+    /// @return The seed the mines were placed with (0 for boards loaded from a file).
+    std::uint64_t getSeed() const;
+
+    /// @return The index of the game within the seed.
+    std::uint64_t getGame() const;
+
+    /// @return `true` if the hint overlay is turned on; `false` otherwise.
+    bool isHintOn() const;
+
+    /// @return The number of mines not yet flagged, as shown by the flag counter. Negative if over-flagged.
+    int getMinesLeft() const;
+
+    /// @return The tile at the specified indices.
+    /// @throws std::out_of_range if the indices are outside of the board.
+    const Tile &getTile(int row, int col) const;
+
+    /// @return A stamp that changes whenever a tile is revealed or (un)flagged.
+    ///         Stamps are unique across all boards, so a board replaced by a new one is noticed as well.
+    std::uint64_t getVersion() const;
+
+    /// @return Indices (row * WIDTH + col) of the tiles revealed or (un)flagged since the last
+    ///         `clearChangedTiles` or `drawUpdates`. A tile may appear more than once.
+    const std::vector<unsigned int> &getChangedTiles() const;
+
+    /// @return Indices of the revealed numbers that still border a hidden, unflagged tile (in no particular order).
+    ///         Maintained as tiles are revealed and flagged, so reading it never scans the board.
+    const std::vector<unsigned int> &getFrontier() const;
+
+    /// @param index The index (row * WIDTH + col) of the tile.
+    /// @return The number of hidden, unflagged tiles adjacent to the tile.
+    unsigned int getUnknownNeighbours(unsigned int index) const;
+
+    /// @param index The index (row * WIDTH + col) of the tile.
+    /// @return The adjacent mines of the tile not yet accounted for by adjacent flags. Negative if over-flagged.
+    int getRemainingMines(unsigned int index) const;
+
     /* -------------------------------- Mutators -------------------------------- */
 
     /// @brief Toggle the debug mode. Display all mines on the board.
     void toggleDebug();
 
+    /// @brief Toggle the hint overlay. Shade hidden tiles by their mine probability.
+    void toggleHint();
+
+    /// @brief Forget the tiles recorded by `getChangedTiles`.
+    void clearChangedTiles();
+
     /// Flag the tile at the specified indices. Does nothing if the tile is already revealed.
     /// @param row The row index of the tile.
     /// @param col The column index of the tile.
@@ -65,56 +127,114 @@ public:
     /// @param col The column index of the tile.
     void revealTile(int row, int col);
 
+    /// @brief Reveal all unflagged tiles adjacent to a revealed number whose adjacent flags match it.
+    ///        Does nothing if the tile is hidden, a zero, or the flag count does not match.
+    /// @param row The row index of the tile.
+    /// @param col The column index of the tile.
+    void chordTile(int row, int col);
+
     /* --------------------------------- Display -------------------------------- */
 
     /// @brief Update the display of all sprites that changed during gameplay.
-    void drawUpdates();
+    ///        Also clears the tiles recorded by `getChangedTiles`.
+    /// @param target The target to draw to. Default the game window.
+    void drawUpdates(sf::RenderTarget &target = Window::window);
+
+    /// @brief Redraw only the tiles recorded by `getChangedTiles` and the button bar, then clear the record.
+    ///        `target` must still hold the previous frame drawn by `drawUpdates` or `drawChanges`.
+    /// @param target The target to draw to.
+    void drawChanges(sf::RenderTarget &target);
 
 private:
     /// @brief Represents a tile on the game board, providing access to specific functionality for the Board class.
     struct BoardTile : public Tile
     {
-        /// @brief Construct a BoardTile object at row `x` and column `y` on the board.
-        /// @param x The row-index of the tile.
-        /// @param y The col-index of the tile.
-        BoardTile(unsigned int x, unsigned int y);
-
         friend class Board;
     };
 
-    std::vector<std::vector<BoardTile *>> tiles; // 2D vector of all tiles in the grid
+    std::vector<BoardTile> tiles;           // All tiles in the grid, stored row by row (index = row * WIDTH + col)
+    std::vector<unsigned int> changedTiles; // Indices of tiles changed since the last draw or clear
+
+    static constexpr unsigned int NOT_IN_FRONTIER = -1; // Frontier slot of tiles outside of the frontier
+    static constexpr unsigned char UNKNOWN_MASK = 0x0F; // Bits 0-3 of a neighbour count: hidden, unflagged adjacent tiles
+    static constexpr unsigned int FLAGGED_SHIFT = 4;    // Bits 4-7 of a neighbour count: flagged adjacent tiles
+
+    std::vector<unsigned char> neighbourCounts; // Packed unknown and flagged adjacent tiles of each tile
+    std::vector<unsigned int> frontier;         // Revealed numbers bordering at least one unknown tile
+    std::vector<unsigned int> frontierSlots;    // Position of each tile in `frontier`, or `NOT_IN_FRONTIER`
 
     unsigned int unrevealedTileCount; // The number of unrevealed tiles (excluding mines)
     unsigned int totalMines;          // The total number of mines on the board
+    std::uint64_t seed;               // Seed of the mine placement
+    std::uint64_t game;               // Index of the game within `seed`
+    std::uint64_t version;            // Stamp of the last change (see `getVersion`)
     int flagCount;                    // The number of flagged tiles
     int faceType;                     // Type of face displayed: `FACE_PLAY, `FACE_LOSE`, `FACE_WIN`
     bool debugON;                     // Turn debug mode on and off
+    bool hintON;                      // Turn the hint overlay on and off
 
     sf::Sprite digit;               // Counter for number of bombs left
     sf::Sprite faceBtn;             // Face that can change emotion
     sf::Sprite testBtns[NUM_TESTS]; // Buttons for tests and debug
     sf::Sprite debugBtn;            // Debug shows all mines
-    sf::Sprite debugMine;           // Mine used to display all mines in debug mode
-
-    /// @brief Constructor helper, initialize basic values and 2D vector of tiles.
+    sf::Sprite hintBtn;             // Hint shades tiles by mine probability
+    sf::Sprite debugMine;           // Mine used to display all mines in debug mode and revealed mines
+    sf::Sprite hiddenTile;          // Background of a hidden tile
+    sf::Sprite revealedTile;        // Background of a revealed tile
+    sf::Sprite flagOverlay;         // Flag drawn over a flagged tile
+    sf::Sprite numberOverlays[8];   // Adjacent mine counts 1-8 drawn over a revealed tile
+
+    /// @brief Constructor helper, initialize basic values and sprites.
     void init();
 
-    /// @brief Constructor helper, initialize the number of adjacent mines for each tile.
-    void initAdjacentMines();
+    /// @brief Constructor helper, initialize the neighbour counts and frontier for the placed mines.
+    void initNeighbours();
+
+    /// @brief Generation helper, place `mines` mines with a partial Fisher-Yates shuffle driven by `seed` and `game`.
+    static std::vector<BoardTile> placeMines(unsigned int mines, std::uint64_t seed, std::uint64_t game);
+
+    /// @brief Generation helper, place the mines read from a board file.
+    static std::vector<BoardTile> readMines(const std::string &file);
+
+    /// @brief Generation helper, set the number of adjacent mines of every tile.
+    static void countAdjacentMines(std::vector<BoardTile> &tiles);
 
     /// @brief Reveal helper, reveal all adjacent tiles that are not mines.
-    void revealTiles(std::stack<BoardTile *> &tilesToProcess);
+    ///        Every tile on the stack is already revealed and is pushed at most once.
+    void revealTiles(std::stack<unsigned int> &tilesToProcess);
+
+    /// @brief Record a revealed or (un)flagged tile in `changedTiles` and take a new version stamp.
+    void markChanged(unsigned int index);
+
+    /// @brief Frontier helper, adjust the neighbour counts around a tile that was revealed or (un)flagged.
+    /// @param index The index of the changed tile.
+    /// @param unknownChange The change to the unknown neighbour count of each adjacent tile.
+    /// @param flagChange The change to the flagged neighbour count of each adjacent tile.
+    void updateNeighbours(unsigned int index, int unknownChange, int flagChange);
 
-    /// @return Vector of pointers to the adjacent tiles at position `x`, `y`.
-    std::vector<BoardTile *> getAdjacentTiles(int x, int y);
+    /// @brief Frontier helper, add or remove a tile from the frontier to match its current state.
+    void updateFrontier(unsigned int index);
+
+    /// @return The mutable tile at the specified indices.
+    /// @throws std::out_of_range if the indices are outside of the board.
+    BoardTile &tileAt(int row, int col);
+
+    /// @return Vector of indices into `tiles` of the adjacent tiles at position `x`, `y`.
+    std::vector<unsigned int> getAdjacentTiles(int x, int y) const;
 
     /// @brief Update the current face type.
     void setFace(int type);
 
-    /// @brief Draw helper, draw the flag counter to the SFML window.
-    void drawFlagCounter();
+    /// @brief Draw helper, draw the tile at the specified indices from its current state.
+    void drawTile(sf::RenderTarget &target, unsigned int row, unsigned int col);
+
+    /// @brief Draw helper, draw the face, debug, hint and test buttons.
+    void drawButtons(sf::RenderTarget &target);
+
+    /// @brief Draw helper, draw the flag counter to `target`.
+    void drawFlagCounter(sf::RenderTarget &target);
 
     /// @brief Draw helper, draw a digit in the flag counter.
-    void drawDigit(int value, int xPos);
+    void drawDigit(sf::RenderTarget &target, int value, int xPos);
 };
 #endif // BOARD_H
\ No newline at end of file
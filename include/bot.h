@@ -0,0 +1,133 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+
+/// @brief A single action requested by an automated player.
+struct BotCommand
+{
+    enum Type
+    {
+        REVEAL, // Reveal a hidden tile
+        FLAG,   // Toggle the flag on a hidden tile
+        CHORD   // Reveal around a revealed number whose flags are satisfied
+    };
+
+    Type type; // The action to perform
+    int row;   // The row index of the tile
+    int col;   // The column index of the tile
+};
+
+/// @brief A tile whose visible value changed while applying a batch of commands.
+struct CellDelta
+{
+    unsigned int row; // The row index of the tile
+    unsigned int col; // The column index of the tile
+    int value;        // The new visible value, see `BoardView::getValue`
+};
+
+/// @brief Read-only view of the information a player is allowed to see.
+///        Reads straight from the board's tiles; nothing is copied.
+class BoardView
+{
+public:
+    static constexpr int HIDDEN = -1;  // Tile is hidden
+    static constexpr int FLAGGED = -2; // Tile is hidden and flagged
+    static constexpr int MINE = -3;    // Tile is a revealed mine
+
+    /// @param board The board to view. Must outlive the view.
+    BoardView(const Board &board);
+
+    /// @param row The row index of the tile.
+    /// @param col The column index of the tile.
+    /// @return The number of adjacent mines (0-8) if the tile is revealed; `HIDDEN`, `FLAGGED` or `MINE` otherwise.
+    int getValue(int row, int col) const;
+
+    /// @return The current face type (Lose/Win/Playable).
+    int getFace() const;
+
+    /// @return Indices (row * WIDTH + col) of the revealed numbers bordering a hidden, unflagged tile.
+    const std::vector<unsigned int> &getFrontier() const;
+
+    /// @param index The index (row * WIDTH + col) of the tile.
+    /// @return The number of hidden, unflagged tiles adjacent to the tile.
+    unsigned int getUnknownNeighbours(unsigned int index) const;
+
+    /// @param index The index (row * WIDTH + col) of the revealed tile.
+    /// @return The adjacent mines of the tile not yet accounted for by adjacent flags.
+    int getRemainingMines(unsigned int index) const;
+
+private:
+    const Board &board; // The viewed board
+};
+
+/// @brief Plays a board without a window, applying batches of commands from an automated player.
+class BotSession
+{
+public:
+    /// @brief Start a session on a randomly generated board.
+    /// @param mines The number of mines on the board.
+    /// @param seed The seed of the mine placement.
+    BotSession(unsigned int mines = 50, std::uint64_t seed = Random::timeSeed());
+
+    /// @brief Replace the current board with a new randomly generated board.
+    /// @param mines The number of mines on the board.
+    /// @param seed The seed of the mine placement.
+    void newGame(unsigned int mines = 50, std::uint64_t seed = Random::timeSeed());
+
+    /// @brief Apply `commands` in order. Commands after the game ends are ignored.
+    /// @return The tiles whose visible value differs from before the batch, each listed once with its final value.
+    ///         A tile flagged and unflagged within the batch is not listed. Valid until the next call.
+    /// @throws std::out_of_range if a command targets a tile outside of the board.
+    ///         Commands before the failing one have already been applied.
+    const std::vector<CellDelta> &apply(const std::vector<BotCommand> &commands);
+
+    /// @return A view of the current board.
+    BoardView getView() const;
+
+    /// @return The seed of the current board, to replay it with `newGame` or an `n <mines> <seed>` line.
+    std::uint64_t getSeed() const;
+
+private:
+    Board board;                     // The board being played
+    std::vector<CellDelta> deltas;   // Changes produced by the last call to `apply`
+    std::vector<signed char> values; // Visible value of each tile as last reported by `apply`
+};
+
+/// @brief Apply a single command to `board`, regardless of the game state.
+/// @throws std::out_of_range if the command targets a tile outside of the board.
+void applyBotCommand(Board &board, const BotCommand &command);
+
+/// @brief Parse a batch line of the line protocol (see `runBotProtocol`) into `commands`.
+/// @param line The line to parse. Must not be an `n` or `q` line.
+/// @param commands The vector the parsed commands are appended to.
+/// @return An empty string if the whole line is valid; the error message otherwise.
+std::string parseBotCommands(const std::string &line, std::vector<BotCommand> &commands);
+
+/// @brief Parse an `n [mines] [seed]` line of the line protocol (see `runBotProtocol`).
+/// @param line The line to parse, starting with `n`.
+/// @param mines Set to the number of mines, or 50 if omitted.
+/// @param seed Set to the seed if one is given; left empty otherwise.
+/// @return An empty string if the whole line is valid; the error message otherwise.
+std::string parseBotNewGame(const std::string &line, unsigned int &mines, std::optional<std::uint64_t> &seed);
+
+/// @brief Run the line protocol for automated players until `in` ends or a `q` command is read.
+///
+///        Every input line is either `n [mines] [seed]` to start a new board, `q` to quit, or a batch of commands:
+///        `r <row> <col>` reveals, `f <row> <col>` toggles a flag and `c <row> <col>` chords.
+///        An `n` line is answered with `play <seed>`, giving the seed even when it was picked from the clock.
+///        Batches sent before the first `n` line play a board whose seed is never reported.
+///        A batch is answered with one line: the face (`play`, `win` or `lose`) followed by
+///        `<row>,<col>,<value>` for each changed tile, where the value is 0-8, `H`, `F` or `M`.
+///        Malformed lines are answered with `error <message>` and have no effect.
+/// @param in The stream commands are read from.
+/// @param out The stream responses are written to.
+void runBotProtocol(std::istream &in, std::ostream &out);
+
+#endif // BOT_H
@@ -0,0 +1,104 @@
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include <SFML/Graphics.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+
+/// @brief Renders board states into an off-screen target and writes them as numbered image files.
+///        Frames are rendered on the calling thread and encoded on worker threads fed through a bounded queue,
+///        so rendering the next frame overlaps with encoding the previous ones.
+///        Every frame is read back and encoded in full, so long games should keep only every few moves.
+class FrameExporter
+{
+public:
+    static constexpr size_t MAX_QUEUED_FRAMES = 32; // Frames waiting for an encoder before rendering blocks
+
+    /* ------------------------------ Constructors ------------------------------ */
+
+    /// @brief Construct a FrameExporter object and start its encoder threads.
+    /// @param directory The existing directory the frames are written to.
+    /// @param extension The image format of the frames: `png`, `bmp`, `tga` or `jpg`.
+    /// @param encoders The number of encoder threads.
+    /// @param period The number of moves drawn per frame written. Default every move.
+    /// @throws std::runtime_error if the off-screen target cannot be created.
+    FrameExporter(const std::string &directory, const std::string &extension, unsigned int encoders,
+                  unsigned int period = 1);
+
+    /// @brief Write the remaining frames and stop the encoder threads.
+    ~FrameExporter();
+
+    FrameExporter(const FrameExporter &) = delete;
+    FrameExporter &operator=(const FrameExporter &) = delete;
+
+    /* -------------------------------- Accessors ------------------------------- */
+
+    /// @return The number of frames captured so far.
+    unsigned int getFrameCount() const;
+
+    /* -------------------------------- Mutators -------------------------------- */
+
+    /// @brief Draw the whole board and queue it as a frame. Use for the first frame of every board.
+    ///        Moves of the previous board not yet written are queued first.
+    void captureFull(Board &board);
+
+    /// @brief Draw only the tiles changed since the last capture, and queue a frame once every `period` moves.
+    ///        Does nothing if no tile changed.
+    void captureChanges(Board &board);
+
+    /// @brief Queue the moves not yet written, wait until every queued frame is written and stop the encoder threads.
+    /// @return The number of frames that could not be written.
+    unsigned int finish();
+
+private:
+    /// @brief A rendered frame waiting to be encoded.
+    struct Frame
+    {
+        unsigned int number;              // Position of the frame in the sequence
+        std::unique_ptr<sf::Image> image; // Pixels of the frame
+    };
+
+    sf::RenderTexture target; // Off-screen render target holding the last frame
+    std::string directory;    // Directory the frames are written to
+    std::string extension;    // Image format of the frames
+    unsigned int frameCount;  // Frames captured so far
+    unsigned int period;      // Moves drawn per frame written
+    unsigned int movesDrawn;  // Moves drawn since the last frame was queued
+
+    std::vector<std::thread> encoders;  // Write queued frames to disk
+    std::mutex mutex;                   // Guards `frames` and `finished`
+    std::condition_variable queued;     // Signals encoders that a frame was queued or capturing finished
+    std::condition_variable dequeued;   // Signals the renderer that the queue has room
+    std::deque<Frame> frames;           // Frames waiting to be encoded
+    bool finished;                      // No more frames will be queued
+    std::atomic<unsigned int> failures; // Frames that could not be written
+
+    /// @brief Capture helper, copy the target into an image and queue it, waiting while the queue is full.
+    void queueFrame();
+
+    /// @brief Capture helper, queue the moves drawn since the last frame, if any.
+    void queueDrawnMoves();
+
+    /// @brief Encoder helper, write queued frames until capturing is finished and the queue is empty.
+    void encode();
+};
+
+/// @brief Run the export mode: replay a recorded bot game off-screen and write one image per move that changed the board.
+///
+///        Arguments: `<replay> <directory> [--format <png|bmp|tga|jpg>] [--encoders <count>] [--every <moves>]`.
+///        The replay uses the bot line protocol (see `runBotProtocol`) and must start with an `n <mines> <seed>` line.
+///        With `--every`, one frame is written per `moves` moves, plus the last state of every board.
+/// @param args The command-line arguments after the mode flag.
+/// @return The process exit code.
+int runExport(const std::vector<std::string> &args);
+
+#endif // EXPORTER_H
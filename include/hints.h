@@ -0,0 +1,92 @@
+#ifndef HINTS_H
+#define HINTS_H
+
+#include <SFML/Graphics.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "board.h"
+
+/// @brief Computes the mine probability of every hidden tile on a worker thread and draws it as an overlay.
+///        Flags are assumed to be correct.
+class Hints
+{
+public:
+    static constexpr sf::Int64 FRAME_BUDGET_US = 2000; // Time per frame spent applying finished results
+    static constexpr long MAX_SOLVER_STEPS = 4000000;  // Give up on the board if a component takes this many steps
+
+    /* ------------------------------ Constructors ------------------------------ */
+
+    /// @brief Construct a Hints object and start its worker thread.
+    Hints();
+
+    /// @brief Stop the worker thread.
+    ~Hints();
+
+    Hints(const Hints &) = delete;
+    Hints &operator=(const Hints &) = delete;
+
+    /* -------------------------------- Mutators -------------------------------- */
+
+    /// @brief Restart the computation if the visible board changed since the last call,
+    ///        then apply finished results until `FRAME_BUDGET_US` is spent.
+    /// @param board The board being played.
+    void update(const Board &board);
+
+    /* --------------------------------- Display -------------------------------- */
+
+    /// @brief Draw the overlay: hidden tiles shaded by mine probability, provably safe tiles highlighted.
+    void draw();
+
+private:
+    /// @brief Immutable copy of everything the worker needs to know about the board.
+    struct Snapshot
+    {
+        unsigned int generation;            // Generation the snapshot belongs to
+        std::vector<int> values;            // Visible value of each tile (see `BoardView::getValue`)
+        std::vector<unsigned int> frontier; // Revealed numbers bordering a hidden, unflagged tile
+        int minesLeft;                      // Mines not yet flagged
+    };
+
+    /// @brief Probabilities for a group of tiles, published by the worker as soon as they are known.
+    struct Result
+    {
+        unsigned int generation;                                   // Generation the result belongs to
+        std::vector<std::pair<unsigned int, float>> probabilities; // Tile index and mine probability
+    };
+
+    std::uint64_t visibleVersion;     // Version of the board at the last update (see `Board::getVersion`)
+    std::vector<float> probabilities; // Mine probability of each tile, negative if not yet known
+
+    std::thread worker;                   // Runs the solver
+    std::mutex mutex;                     // Guards `pending`, `results` and `stopping`
+    std::condition_variable wake;         // Wakes the worker for a new snapshot or to stop
+    std::atomic<unsigned int> generation; // Incremented whenever the board changes; cancels older work
+    std::optional<Snapshot> pending;      // Next snapshot to solve
+    std::deque<Result> results;           // Finished results not yet applied
+    bool stopping;                        // Worker should exit
+
+    sf::RectangleShape shade; // Shading drawn over a hidden tile
+
+    /// @brief Worker helper, wait for snapshots and solve them until stopped.
+    void work();
+
+    /// @brief Worker helper, enumerate every frontier component of a snapshot, combine their mine counts exactly,
+    ///        then publish the probabilities component by component.
+    void solve(const Snapshot &snapshot);
+
+    /// @brief Worker helper, queue a result unless its snapshot has been superseded.
+    void publish(Result &&result);
+
+    /// @return `true` if a newer snapshot has replaced the one with `snapshotGeneration`.
+    bool cancelled(unsigned int snapshotGeneration) const;
+};
+
+#endif // HINTS_H
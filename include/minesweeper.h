@@ -3,13 +3,21 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "analytics.h"
 #include "board.h"
+#include "bot.h"
+#include "exporter.h"
+#include "hints.h"
 #include "textures.h"
 #include "window.h"
 
 #define TEST_BRD_PATH "../data/boards/"           // Relative path to test board file folder
 #define TEST_BRD_PREFIX TEST_BRD_PATH "testboard" // Add character number 1-3.brd to this
 
+#define BOT_ARG "--bot"         // Command-line flag to play through the bot protocol on stdin/stdout
+#define ANALYZE_ARG "--analyze" // Command-line flag to write board analytics as CSV to stdout
+#define EXPORT_ARG "--export"   // Command-line flag to render a replay to image files off-screen
+
 /* ------------------------------- Application ------------------------------ */
 
 /// @brief Run the game until the window is closed.
@@ -0,0 +1,17 @@
+#ifndef PARSE_H
+#define PARSE_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+/// @brief Parse a non-negative whole number written with digits only.
+///        Signs, spaces, trailing characters and values above `max` are rejected.
+/// @param text The text to parse.
+/// @param value Set to the parsed number if `text` is valid; left unchanged otherwise.
+/// @param max The largest accepted value. Default any 64-bit value.
+/// @return An empty string if `text` is valid; the error message otherwise.
+std::string parseNumber(const std::string &text, std::uint64_t &value,
+                        std::uint64_t max = std::numeric_limits<std::uint64_t>::max());
+
+#endif // PARSE_H
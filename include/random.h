@@ -1,16 +1,51 @@
 #ifndef RANDOM_H
 #define RANDOM_H
 
-#include <random>
+#include <cstdint>
+#include <limits>
 
-struct Random
+/// @brief Counter-based pseudo-random number generator (SplitMix64 output function over a counter).
+///        Each (seed, game, stream) selects its own sequence in O(1), and any position in it can be
+///        reached in O(1). The whole state is two 64-bit words, so copies are cheap and share nothing
+///        between threads. Satisfies UniformRandomBitGenerator.
+class Random
 {
 public:
-    static std::mt19937 &getGenerator();
+    using result_type = std::uint64_t;
+
+    /* ------------------------------ Constructors ------------------------------ */
+
+    /// @brief Construct a generator at the start of the sequence selected by `seed`, `game` and `stream`.
+    /// @param seed The base seed, e.g. of a tournament or batch run.
+    /// @param game The index of the game within the seed.
+    /// @param stream The independent stream within the game (e.g. mine placement).
+    Random(std::uint64_t seed, std::uint64_t game = 0, std::uint64_t stream = 0);
+
+    /* -------------------------------- Accessors ------------------------------- */
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /// @return A seed derived from the clock, distinct on every call, for boards nobody needs to reproduce.
+    static std::uint64_t timeSeed();
+
+    /* -------------------------------- Mutators -------------------------------- */
+
+    /// @return The next 64-bit value of the sequence.
+    result_type operator()();
+
+    /// @return A uniformly distributed integer in [0, `bound`). `bound` must be non-zero.
+    std::uint32_t uniform(std::uint32_t bound);
+
+    /// @brief Skip the next `count` values of the sequence in O(1).
+    void discard(std::uint64_t count);
 
 private:
-    // Use Mersenne Twister pseudo-random number generator for random boards
-    static std::mt19937 random;
+    std::uint64_t key;     // Start of the sequence selected by (seed, game, stream)
+    std::uint64_t counter; // Number of values drawn from the sequence
+
+    /// @return `value` with its bits thoroughly mixed (SplitMix64 finalizer).
+    static std::uint64_t mix(std::uint64_t value);
 };
 
-#endif // RANDOM_H
\ No newline at end of file
+#endif // RANDOM_H
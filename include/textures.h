@@ -21,6 +21,7 @@
 #define FACE_WIN_PNG IMAGES_PATH "face_win.png"
 
 #define DEBUG_BTN_PNG IMAGES_PATH "debug.png"
+#define HINT_BTN_PNG IMAGES_PATH "hint.png"
 #define TEST_PNG_PREFIX IMAGES_PATH "test_" // Add character number 1-3.png to this
 
 #define DIGITS_PNG IMAGES_PATH "digits.png"
@@ -35,10 +36,15 @@ public:
 	/// @return The texture object associated with the passed in name
 	static std::shared_ptr<sf::Texture> getTexture(const std::string &name);
 
+	/// @brief Hand out empty textures instead of loading image files.
+	///        Used by headless modes that never draw and have no OpenGL context.
+	static void setHeadless(bool enabled);
+
 private:
 	// Use smart pointers to ensure proper deletion of textures once they are no longer being used
 
 	static std::unordered_map<std::string, std::shared_ptr<sf::Texture>> textures; // Texture map
+	static bool headless;                                                          // Skip loading image files
 
 	/// @brief Load a texture into the texture map from an image file
 	static void loadTexture(const std::string &file);
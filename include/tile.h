@@ -1,26 +1,17 @@
 #ifndef TILE_H
 #define TILE_H
 
-#include <SFML/Graphics.hpp>
-
-#include <vector>
-
-#include "textures.h"
-#include "window.h"
+#include <cstdint>
 
 /// @brief Represents a single tile in the Minesweeper board.
+///        The whole tile state is packed into one byte; its position is derived from its index in the board.
 class Tile
 {
 public:
-    const unsigned int x; // The x position of the tile on the board
-    const unsigned int y; // The y position of the tile on the board
-
     /* ------------------------------ Constructors ------------------------------ */
 
-    /// @brief Construct a Tile object at row `x` and column `y` on the board. Default (0, 0)
-    /// @param x Row x.
-    /// @param y Column y.
-    Tile(unsigned int x = 0, unsigned int y = 0);
+    /// @brief Construct a hidden, unflagged Tile object with no adjacent mines.
+    Tile();
 
     /* -------------------------------- Accessors ------------------------------- */
 
@@ -33,38 +24,32 @@ public:
     /// @return `true` if the tile is a mine; `false` otherwise.
     bool isMine() const;
 
-protected:
     /// @return The number of adjacent mines to the tile.
     unsigned int getAdjacentMineCount() const;
 
-    /// @return The tile sprite.
-    const sf::Sprite &getTileSprite() const;
-
-    /// @return The overlayed tile sprite (flagging and debug mine)
-    const sf::Sprite &getOverlaySprite() const;
-
+protected:
     /// @brief Mark the tile as a mine.
     void setMine();
 
     /// @brief Set the number of adjacent mines for the tile.
-    /// @param mines The number of adjacent mines.
+    /// @param mines The number of adjacent mines (0-8).
     void setAdjacentMineCount(unsigned int mines);
 
-    /// @brief Mark the tile as revealed and update the tile sprite.
+    /// @brief Mark the tile as revealed.
     void revealTile();
 
-    /// @brief Mark the tile as flagged or not and update the tile sprite.
+    /// @brief Mark the tile as flagged or not.
     void toggleFlag();
 
 private:
-    bool revealed; // Tile is revealed
-    bool flagged;  // Tile is flagged
-    bool mine;     // Tile is a mine
+    static constexpr std::uint8_t ADJACENT_MASK = 0x0F; // Bits 0-3 hold the number of adjacent mines
+    static constexpr std::uint8_t REVEALED_BIT = 0x10;  // Tile is revealed
+    static constexpr std::uint8_t FLAGGED_BIT = 0x20;   // Tile is flagged
+    static constexpr std::uint8_t MINE_BIT = 0x40;      // Tile is a mine
 
-    sf::Sprite tileSprite;    // The tile sprite
-    sf::Sprite overlaySprite; // The overlayed tile sprite (flagging and debug mine)
-
-    unsigned int adjacentMineCount; // Number of adjacent tiles that are mines
+    std::uint8_t state; // Packed tile state
 };
 
-#endif // TILE_H
\ No newline at end of file
+static_assert(sizeof(Tile) == 1, "Tile state must fit in a single byte");
+
+#endif // TILE_H
@@ -6,6 +6,9 @@
 
 struct Window
 {
+    static constexpr unsigned int WIDTH = 800;  // The width of the window in pixels
+    static constexpr unsigned int HEIGHT = 600; // The height of the window in pixels
+
     static sf::RenderWindow window; // The main RenderWindow object
 
     /// @brief Initializes the application window.
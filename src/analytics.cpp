@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include "analytics.h"
+#include "parse.h"
+
+/* --------------------------------- Helpers -------------------------------- */
+
+/// @return The representative of the set containing `index`, compressing the path on the way.
+static unsigned int findRoot(std::vector<unsigned int> &parents, unsigned int index)
+{
+    while (parents[index] != index)
+    {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+    return index;
+}
+
+/// @brief Call `analyze(i)` for every `i` in [0, `count`) spread over `threads` threads.
+template <typename Analyze>
+static void parallelFor(size_t count, unsigned int threads, const Analyze &analyze)
+{
+    static constexpr size_t CHUNK = 256; // Boards claimed by a thread at a time
+
+    std::atomic<size_t> next{0};
+    auto work = [&]
+    {
+        for (size_t start; (start = next.fetch_add(CHUNK)) < count;)
+            for (size_t i = start; i < std::min(start + CHUNK, count); ++i)
+                analyze(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+    work();
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+/* -------------------------------- Analysis -------------------------------- */
+
+BoardStats analyzeBoard(const std::vector<Tile> &tiles)
+{
+    constexpr unsigned int REGION_COLS = (Board::WIDTH + BoardStats::REGION_SIZE - 1) / BoardStats::REGION_SIZE;
+    constexpr unsigned int REGION_ROWS = (Board::HEIGHT + BoardStats::REGION_SIZE - 1) / BoardStats::REGION_SIZE;
+    static_assert(BoardStats::REGION_SIZE <= Board::WIDTH && BoardStats::REGION_SIZE <= Board::HEIGHT,
+                  "Regions must fit inside the board");
+
+    BoardStats stats{};
+    std::vector<unsigned int> parents(Board::WIDTH * Board::HEIGHT);
+    std::vector<unsigned int> sizes(Board::WIDTH * Board::HEIGHT, 1);
+    std::vector<char> bordersOpening(Board::WIDTH * Board::HEIGHT, false);
+    std::iota(parents.begin(), parents.end(), 0);
+
+    unsigned int zeros = 0;
+    unsigned int unions = 0;
+    unsigned int numbers = 0;
+    unsigned int borderingNumbers = 0;
+
+    const int row[]{-1, -1, -1, 1, 1, 1, 0, 0};
+    const int col[]{-1, 0, 1, -1, 0, 1, -1, 1};
+
+    for (int i = 0; i < Board::HEIGHT; ++i)
+    {
+        for (int j = 0; j < Board::WIDTH; ++j)
+        {
+            unsigned int index = i * Board::WIDTH + j;
+            const Tile &tile = tiles[index];
+            if (tile.isMine())
+            {
+                ++stats.mines;
+                continue;
+            }
+
+            if (tile.getAdjacentMineCount() != 0)
+            {
+                ++numbers;
+                continue;
+            }
+
+            ++zeros;
+            for (int k = 0; k < 8; ++k)
+            {
+                int x = i + row[k];
+                int y = j + col[k];
+                if (x < 0 || x >= Board::HEIGHT || y < 0 || y >= Board::WIDTH)
+                    continue;
+
+                unsigned int adjacent = x * Board::WIDTH + y;
+                const Tile &adjacentTile = tiles[adjacent];
+                if (adjacentTile.isMine())
+                    continue;
+
+                // Numbers next to an opening are revealed by it (counted once, whether seen before or after)
+                if (adjacentTile.getAdjacentMineCount() != 0)
+                {
+                    if (!bordersOpening[adjacent])
+                    {
+                        bordersOpening[adjacent] = true;
+                        ++borderingNumbers;
+                    }
+                    continue;
+                }
+
+                // Join with zero tiles already visited (union by size)
+                if (adjacent > index)
+                    continue;
+
+                unsigned int a = findRoot(parents, index);
+                unsigned int b = findRoot(parents, adjacent);
+                if (a == b)
+                    continue;
+                if (sizes[a] < sizes[b])
+                    std::swap(a, b);
+                parents[b] = a;
+                sizes[a] += sizes[b];
+                ++unions;
+            }
+
+            stats.largestOpening = std::max(stats.largestOpening, sizes[findRoot(parents, index)]);
+        }
+    }
+
+    // Every opening and every number outside of an opening takes one click
+    stats.openings = zeros - unions;
+    stats.isolatedNumbers = numbers - borderingNumbers;
+    stats.threeBV = stats.openings + stats.isolatedNumbers;
+
+    // The last region of a row or column is moved back inside the board, so every region has the same size
+    stats.minRegionDensity = 1.0f;
+    for (unsigned int i = 0; i < REGION_ROWS; ++i)
+    {
+        for (unsigned int j = 0; j < REGION_COLS; ++j)
+        {
+            unsigned int top = std::min(i * BoardStats::REGION_SIZE, Board::HEIGHT - BoardStats::REGION_SIZE);
+            unsigned int left = std::min(j * BoardStats::REGION_SIZE, Board::WIDTH - BoardStats::REGION_SIZE);
+
+            unsigned int mines = 0;
+            for (unsigned int x = top; x < top + BoardStats::REGION_SIZE; ++x)
+            {
+                for (unsigned int y = left; y < left + BoardStats::REGION_SIZE; ++y)
+                    mines += tiles[x * Board::WIDTH + y].isMine();
+            }
+
+            float density = (float)mines / (BoardStats::REGION_SIZE * BoardStats::REGION_SIZE);
+            stats.minRegionDensity = std::min(stats.minRegionDensity, density);
+            stats.maxRegionDensity = std::max(stats.maxRegionDensity, density);
+        }
+    }
+
+    return stats;
+}
+
+/* ------------------------------- Batch Mode ------------------------------- */
+
+int runAnalytics(const std::vector<std::string> &args, std::ostream &out)
+{
+    static constexpr unsigned int MAX_THREADS = 1024; // Most threads accepted by `--threads`
+
+    size_t count = 1000;
+    unsigned int mines = 50;
+    std::uint64_t seed = Random::timeSeed();
+    unsigned int threads = std::min(MAX_THREADS, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::string> files;
+
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        bool hasValue = i + 1 < args.size();
+        std::uint64_t value = 0;
+        std::string error;
+        if (args[i] == "--boards" && hasValue)
+        {
+            error = parseNumber(args[++i], value, std::numeric_limits<size_t>::max());
+            count = value;
+        }
+        else if (args[i] == "--mines" && hasValue)
+        {
+            error = parseNumber(args[++i], value, Board::WIDTH * Board::HEIGHT);
+            mines = value;
+        }
+        else if (args[i] == "--seed" && hasValue)
+            error = parseNumber(args[++i], seed);
+        else if (args[i] == "--threads" && hasValue)
+        {
+            error = parseNumber(args[++i], value, MAX_THREADS);
+            threads = std::max<std::uint64_t>(1, value);
+        }
+        else if (args[i].rfind("--", 0) == 0)
+            error = "unknown option '" + args[i] + "'";
+        else
+            files.push_back(args[i]);
+
+        if (!error.empty())
+        {
+            std::cerr << "ERROR: " << error << std::endl;
+            return 1;
+        }
+    }
+
+    if (!files.empty())
+        count = files.size();
+
+    // Never start more threads than there are boards to share between them
+    threads = std::max<size_t>(1, std::min<size_t>(threads, count));
+
+    static constexpr size_t BATCH_PER_THREAD = 4096; // Boards analyzed per thread before their rows are written
+
+    // Analyze one batch at a time and write its rows in order, so memory does not grow with `count`
+    size_t batchSize = BATCH_PER_THREAD * threads;
+    std::vector<BoardStats> results(std::min(batchSize, count));
+    std::vector<std::string> errors(results.size());
+
+    int status = 0;
+    out << "source,game,mines,3bv,openings,largest_opening,isolated_numbers,min_region_density,max_region_density\n";
+    for (size_t first = 0; first < count; first += batchSize)
+    {
+        size_t size = std::min(batchSize, count - first);
+        auto analyze = [&](size_t i)
+        {
+            try
+            {
+                size_t board = first + i;
+                results[i] = analyzeBoard(files.empty() ? Board::generateTiles(mines, seed, board)
+                                                        : Board::loadTiles(files[board]));
+            }
+            catch (const std::exception &e)
+            {
+                errors[i] = e.what();
+            }
+        };
+        parallelFor(size, threads, analyze);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (!errors[i].empty())
+            {
+                std::cerr << errors[i] << std::endl;
+                errors[i].clear();
+                status = 1;
+                continue;
+            }
+
+            size_t board = first + i;
+            const BoardStats &stats = results[i];
+            out << (files.empty() ? std::to_string(seed) : files[board]) << ',' << (files.empty() ? board : 0) << ','
+                << stats.mines << ',' << stats.threeBV << ',' << stats.openings << ',' << stats.largestOpening << ','
+                << stats.isolatedNumbers << ',' << stats.minRegionDensity << ',' << stats.maxRegionDensity << '\n';
+        }
+    }
+    out.flush();
+
+    return status;
+}
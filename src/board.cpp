@@ -1,77 +1,40 @@
-#include <random>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
+#include <numeric>
 #include <stack>
 
 #include "board.h"
 
+static std::atomic<std::uint64_t> lastVersion{0}; // Last version stamp handed out to any board
+
 /* ------------------------------ Constructors ------------------------------ */
 
-Board::Board(unsigned int mines) : totalMines{mines}
+Board::Board(unsigned int mines, std::uint64_t seed, std::uint64_t game)
+    : tiles{placeMines(mines, seed, game)}, totalMines{mines}, seed{seed}, game{game}
 {
-    if (totalMines > WIDTH * HEIGHT)
-        throw std::runtime_error("ERROR: Number of mines exceeds total possible tile locations.");
     unrevealedTileCount = (WIDTH * HEIGHT) - totalMines;
 
     init();
-
-    // Place mines in random positions
-    std::vector<std::pair<int, int>> availablePositions;
-    for (int x = 0; x < HEIGHT; ++x)
-        for (int y = 0; y < WIDTH; ++y)
-            availablePositions.push_back(std::make_pair(x, y));
-
-    std::shuffle(availablePositions.begin(), availablePositions.end(), Random::getGenerator());
-
-    for (int i = 0; i < mines; ++i)
-    {
-        int randX = availablePositions[i].first;
-        int randY = availablePositions[i].second;
-        tiles[randX][randY]->setMine();
-    }
-
-    initAdjacentMines();
+    countAdjacentMines(tiles);
+    initNeighbours();
 }
 
-Board::Board(const std::string &file) : totalMines{0}
+Board::Board(const std::string &file) : tiles{readMines(file)}, seed{0}, game{0}
 {
-    init();
-
-    std::ifstream boardFile(file);
-    if (!boardFile.is_open())
-        throw std::runtime_error("The file " + file + " could not be opened.");
-
-    std::string line;
-    int i = 0;
-    while (getline(boardFile, line))
-    {
-        if (line.length() != WIDTH)
-            throw std::runtime_error("ERROR: Number of columns exceeds WIDTH of " + std::to_string(WIDTH));
-
-        // '1's indicate a mine
-        for (int j = 0; j < line.length(); ++j)
-        {
-            if (line[j] == '1')
-            {
-                tiles[i][j]->setMine();
-                ++totalMines;
-            }
-        }
-
-        if (i >= HEIGHT)
-            throw std::runtime_error("ERROR: Number of rows exceeds HEIGHT of " + std::to_string(HEIGHT));
-
-        ++i;
-    }
-
+    totalMines = std::count_if(tiles.begin(), tiles.end(), [](const BoardTile &tile) { return tile.isMine(); });
     unrevealedTileCount = (WIDTH * HEIGHT) - totalMines;
 
-    initAdjacentMines();
+    init();
+    countAdjacentMines(tiles);
+    initNeighbours();
 }
 
 void Board::init()
 {
+    version = ++lastVersion;
     debugON = false;
+    hintON = false;
     flagCount = 0;
 
     // Initialize the sprite textures and positions (starting game state)
@@ -82,7 +45,15 @@ void Board::init()
     debugBtn.setTexture(*Textures::getTexture(DEBUG_BTN_PNG));
     debugBtn.setPosition((WIDTH * IMAGESIZE) - (10 * IMAGESIZE), HEIGHT * IMAGESIZE);
 
+    hintBtn.setTexture(*Textures::getTexture(HINT_BTN_PNG));
+    hintBtn.setPosition((WIDTH * IMAGESIZE) - (2 * IMAGESIZE), HEIGHT * IMAGESIZE);
+
     debugMine.setTexture(*Textures::getTexture(TILE_MINE_PNG));
+    hiddenTile.setTexture(*Textures::getTexture(TILE_HIDDEN_PNG));
+    revealedTile.setTexture(*Textures::getTexture(TILE_REVEALED_PNG));
+    flagOverlay.setTexture(*Textures::getTexture(TILE_FLAG_PNG));
+    for (int i = 0; i < 8; ++i)
+        numberOverlays[i].setTexture(*Textures::getTexture(TILE_NUMBER_PNG_PREFIX + std::to_string(i + 1) + ".png"));
 
     digit.setTexture(*Textures::getTexture(DIGITS_PNG));
 
@@ -92,52 +63,149 @@ void Board::init()
         testBtns[i].setTexture(*Textures::getTexture(TEST_PNG_PREFIX + std::to_string(i + 1) + ".png"));
         testBtns[i].setPosition(WIDTH * IMAGESIZE - (offset * IMAGESIZE), HEIGHT * IMAGESIZE);
     }
+}
+
+void Board::initNeighbours()
+{
+    neighbourCounts.assign(WIDTH * HEIGHT, 0);
+    frontier.clear();
+    frontierSlots.assign(WIDTH * HEIGHT, NOT_IN_FRONTIER);
 
-    // Initialize tiles in the grid
     for (int i = 0; i < HEIGHT; ++i)
     {
-        std::vector<BoardTile *> tilesRow;
         for (int j = 0; j < WIDTH; ++j)
+            neighbourCounts[i * WIDTH + j] = getAdjacentTiles(i, j).size();
+    }
+}
+
+/* ------------------------------- Generation ------------------------------- */
+
+std::vector<Tile> Board::generateTiles(unsigned int mines, std::uint64_t seed, std::uint64_t game)
+{
+    std::vector<BoardTile> tiles = placeMines(mines, seed, game);
+    countAdjacentMines(tiles);
+    return {tiles.begin(), tiles.end()};
+}
+
+std::vector<Tile> Board::loadTiles(const std::string &file)
+{
+    std::vector<BoardTile> tiles = readMines(file);
+    countAdjacentMines(tiles);
+    return {tiles.begin(), tiles.end()};
+}
+
+std::vector<Board::BoardTile> Board::placeMines(unsigned int mines, std::uint64_t seed, std::uint64_t game)
+{
+    if (mines > WIDTH * HEIGHT)
+        throw std::runtime_error("ERROR: Number of mines exceeds total possible tile locations.");
+
+    std::vector<BoardTile> tiles(WIDTH * HEIGHT);
+
+    // Place mines in random positions (partial Fisher-Yates shuffle, only the first `mines` positions are drawn)
+    std::vector<unsigned int> availablePositions(WIDTH * HEIGHT);
+    std::iota(availablePositions.begin(), availablePositions.end(), 0);
+
+    Random random(seed, game, MINE_STREAM);
+    for (unsigned int i = 0; i < mines; ++i)
+    {
+        std::swap(availablePositions[i], availablePositions[i + random.uniform(WIDTH * HEIGHT - i)]);
+        tiles[availablePositions[i]].setMine();
+    }
+
+    return tiles;
+}
+
+std::vector<Board::BoardTile> Board::readMines(const std::string &file)
+{
+    std::vector<BoardTile> tiles(WIDTH * HEIGHT);
+
+    std::ifstream boardFile(file);
+    if (!boardFile.is_open())
+        throw std::runtime_error("The file " + file + " could not be opened.");
+
+    std::string line;
+    int i = 0;
+    while (getline(boardFile, line))
+    {
+        if (line.length() != WIDTH)
+            throw std::runtime_error("ERROR: Number of columns exceeds WIDTH of " + std::to_string(WIDTH));
+
+        if (i >= HEIGHT)
+            throw std::runtime_error("ERROR: Number of rows exceeds HEIGHT of " + std::to_string(HEIGHT));
+
+        // '1's indicate a mine
+        for (int j = 0; j < line.length(); ++j)
         {
-            BoardTile *tile = new BoardTile(i, j);
-            tilesRow.push_back(tile);
+            if (line[j] == '1')
+                tiles[i * WIDTH + j].setMine();
         }
-        tiles.push_back(tilesRow);
+
+        ++i;
     }
+
+    return tiles;
 }
 
-void Board::initAdjacentMines()
+void Board::countAdjacentMines(std::vector<BoardTile> &tiles)
 {
+    // Add each mine to its neighbours, so the work grows with the mines rather than the tiles
+    unsigned char counts[WIDTH * HEIGHT]{};
     for (int i = 0; i < HEIGHT; ++i)
     {
         for (int j = 0; j < WIDTH; ++j)
         {
-            int mines = 0;
-            for (BoardTile *adjacent : getAdjacentTiles(i, j))
+            if (!tiles[i * WIDTH + j].isMine())
+                continue;
+
+            for (int x = std::max(i - 1, 0); x <= std::min(i + 1, (int)HEIGHT - 1); ++x)
             {
-                if (adjacent->isMine())
-                    ++mines;
+                for (int y = std::max(j - 1, 0); y <= std::min(j + 1, (int)WIDTH - 1); ++y)
+                    ++counts[x * WIDTH + y];
             }
-
-            tiles[i][j]->setAdjacentMineCount(mines);
+            --counts[i * WIDTH + j];
         }
     }
-}
 
-Board::BoardTile::BoardTile(unsigned int x, unsigned int y) : Tile{x, y} {}
+    for (unsigned int i = 0; i < WIDTH * HEIGHT; ++i)
+        tiles[i].setAdjacentMineCount(counts[i]);
+}
 
 /* -------------------------------- Accessors ------------------------------- */
 
 const sf::Sprite &Board::getFaceButton() const { return faceBtn; }
 const sf::Sprite *Board::getTestButtons() const { return testBtns; }
 const sf::Sprite &Board::getDebugButton() const { return debugBtn; }
+const sf::Sprite &Board::getHintButton() const { return hintBtn; }
 int Board::getFace() const { return faceType; }
+std::uint64_t Board::getSeed() const { return seed; }
+std::uint64_t Board::getGame() const { return game; }
+std::uint64_t Board::getVersion() const { return version; }
+bool Board::isHintOn() const { return hintON; }
+int Board::getMinesLeft() const { return totalMines - flagCount; }
+const std::vector<unsigned int> &Board::getChangedTiles() const { return changedTiles; }
+const std::vector<unsigned int> &Board::getFrontier() const { return frontier; }
+unsigned int Board::getUnknownNeighbours(unsigned int index) const { return neighbourCounts.at(index) & UNKNOWN_MASK; }
+int Board::getRemainingMines(unsigned int index) const { return (int)tiles.at(index).getAdjacentMineCount() - (neighbourCounts[index] >> FLAGGED_SHIFT); }
+
+const Tile &Board::getTile(int row, int col) const
+{
+    if (row < 0 || row >= HEIGHT || col < 0 || col >= WIDTH)
+        throw std::out_of_range("ERROR: Tile (" + std::to_string(row) + ", " + std::to_string(col) + ") is outside of the board.");
+
+    return tiles[row * WIDTH + col];
+}
 
 // Private Helper Accessor
 
-std::vector<Board::BoardTile *> Board::getAdjacentTiles(int x, int y)
+Board::BoardTile &Board::tileAt(int row, int col)
+{
+    return const_cast<BoardTile &>(static_cast<const BoardTile &>(getTile(row, col)));
+}
+
+std::vector<unsigned int> Board::getAdjacentTiles(int x, int y) const
 {
-    std::vector<BoardTile *> adjacentTiles;
+    std::vector<unsigned int> adjacentTiles;
+    adjacentTiles.reserve(8);
 
     const int row[]{-1, -1, -1, 1, 1, 1, 0, 0};
     const int col[]{-1, 0, 1, -1, 0, 1, -1, 1};
@@ -145,7 +213,7 @@ std::vector<Board::BoardTile *> Board::getAdjacentTiles(int x, int y)
     for (int i = 0; i < 8; ++i)
     {
         if (x + row[i] >= 0 && x + row[i] < HEIGHT && y + col[i] >= 0 && y + col[i] < WIDTH)
-            adjacentTiles.push_back(tiles[x + row[i]][y + col[i]]);
+            adjacentTiles.push_back((x + row[i]) * WIDTH + (y + col[i]));
     }
 
     return adjacentTiles;
@@ -154,16 +222,24 @@ std::vector<Board::BoardTile *> Board::getAdjacentTiles(int x, int y)
 /* -------------------------------- Mutators -------------------------------- */
 
 void Board::toggleDebug() { debugON = !debugON; }
+void Board::toggleHint() { hintON = !hintON; }
+void Board::clearChangedTiles() { changedTiles.clear(); }
 
 void Board::flagTile(int row, int col)
 {
-    BoardTile *tile = tiles.at(row).at(col);
-    if (tile->isRevealed())
+    BoardTile &tile = tileAt(row, col);
+    if (tile.isRevealed())
         return;
 
-    tile->toggleFlag();
+    tile.toggleFlag();
+    markChanged(row * WIDTH + col);
 
-    if (tile->isFlagged())
+    if (tile.isFlagged())
+        updateNeighbours(row * WIDTH + col, -1, 1);
+    else
+        updateNeighbours(row * WIDTH + col, 1, -1);
+
+    if (tile.isFlagged())
         ++flagCount;
     else
         --flagCount;
@@ -171,23 +247,25 @@ void Board::flagTile(int row, int col)
 
 void Board::revealTile(int row, int col)
 {
-    BoardTile *tile = tiles.at(row).at(col);
-    if (tile->isFlagged() || tile->isRevealed())
+    BoardTile &tile = tileAt(row, col);
+    if (tile.isFlagged() || tile.isRevealed())
         return;
 
-    tile->revealTile();
+    tile.revealTile();
+    markChanged(row * WIDTH + col);
+    updateNeighbours(row * WIDTH + col, -1, 0);
+    updateFrontier(row * WIDTH + col);
     --unrevealedTileCount;
 
-    if (tile->isMine())
+    if (tile.isMine())
     {
         setFace(FACE_LOSE);
         return;
     }
 
-    // Use a stack to process adjacent tiles
-    std::stack<BoardTile *> tilesToProcess;
-    for (BoardTile *adjacent : getAdjacentTiles(tile->x, tile->y))
-        tilesToProcess.push(adjacent);
+    // Use a stack of revealed tiles whose neighbours still need to be processed
+    std::stack<unsigned int> tilesToProcess;
+    tilesToProcess.push(row * WIDTH + col);
 
     revealTiles(tilesToProcess);
 
@@ -197,33 +275,100 @@ void Board::revealTile(int row, int col)
     }
 }
 
-void Board::revealTiles(std::stack<BoardTile *> &tilesToProcess)
+void Board::revealTiles(std::stack<unsigned int> &tilesToProcess)
 {
     while (!tilesToProcess.empty())
     {
-        BoardTile *curr = tilesToProcess.top();
+        unsigned int curr = tilesToProcess.top();
         tilesToProcess.pop();
 
-        // Ignore mines, flags, and already revealed tiles
-        if (curr->isMine() || curr->isFlagged() || curr->isRevealed())
-            continue;
+        for (unsigned int adjacent : getAdjacentTiles(curr / WIDTH, curr % WIDTH))
+        {
+            BoardTile &tile = tiles[adjacent];
+
+            // Ignore mines, flags, and already revealed tiles
+            if (tile.isMine() || tile.isFlagged() || tile.isRevealed())
+                continue;
+
+            // Claim the tile as soon as it is discovered so it is never pushed twice
+            tile.revealTile();
+            markChanged(adjacent);
+            updateNeighbours(adjacent, -1, 0);
+            updateFrontier(adjacent);
+            --unrevealedTileCount;
+
+            // Don't reveal more tiles if the adjacent tile has adjacent mines
+            if (tile.getAdjacentMineCount() == 0)
+                tilesToProcess.push(adjacent);
+        }
+    }
+}
+
+void Board::chordTile(int row, int col)
+{
+    BoardTile &tile = tileAt(row, col);
+    if (!tile.isRevealed() || tile.isMine() || tile.getAdjacentMineCount() == 0)
+        return;
 
-        curr->revealTile();
-        --unrevealedTileCount;
+    std::vector<unsigned int> adjacentTiles = getAdjacentTiles(row, col);
+    unsigned int flags = 0;
+    for (unsigned int adjacent : adjacentTiles)
+    {
+        if (tiles[adjacent].isFlagged())
+            ++flags;
+    }
 
-        // Don't reveal more tiles if current had adjacent mines
-        if (curr->getAdjacentMineCount() != 0)
-            continue;
+    if (flags != tile.getAdjacentMineCount())
+        return;
 
-        for (BoardTile *adjacent : getAdjacentTiles(curr->x, curr->y))
-        {
-            tilesToProcess.push(adjacent);
-        }
+    // Stop as soon as a wrongly flagged neighbour ends the game
+    for (unsigned int adjacent : adjacentTiles)
+    {
+        if (faceType != FACE_PLAY)
+            break;
+        revealTile(adjacent / WIDTH, adjacent % WIDTH);
     }
 }
 
 // Private Helper Mutator
 
+void Board::markChanged(unsigned int index)
+{
+    changedTiles.push_back(index);
+    version = ++lastVersion;
+}
+
+void Board::updateNeighbours(unsigned int index, int unknownChange, int flagChange)
+{
+    for (unsigned int adjacent : getAdjacentTiles(index / WIDTH, index % WIDTH))
+    {
+        // Both packed counts stay within 0-8, so one addition updates them without carrying between them
+        neighbourCounts[adjacent] += unknownChange + flagChange * (1 << FLAGGED_SHIFT);
+        updateFrontier(adjacent);
+    }
+}
+
+void Board::updateFrontier(unsigned int index)
+{
+    const BoardTile &tile = tiles[index];
+    bool inFrontier = tile.isRevealed() && !tile.isMine() && tile.getAdjacentMineCount() != 0 && (neighbourCounts[index] & UNKNOWN_MASK) != 0;
+
+    if (inFrontier && frontierSlots[index] == NOT_IN_FRONTIER)
+    {
+        frontierSlots[index] = frontier.size();
+        frontier.push_back(index);
+    }
+    else if (!inFrontier && frontierSlots[index] != NOT_IN_FRONTIER)
+    {
+        // Swap the last frontier tile into the removed tile's slot
+        unsigned int last = frontier.back();
+        frontier[frontierSlots[index]] = last;
+        frontierSlots[last] = frontierSlots[index];
+        frontier.pop_back();
+        frontierSlots[index] = NOT_IN_FRONTIER;
+    }
+}
+
 void Board::setFace(int type)
 {
     faceType = type;
@@ -245,41 +390,84 @@ void Board::setFace(int type)
 
 /* --------------------------------- Display -------------------------------- */
 
-void Board::drawUpdates()
+void Board::drawUpdates(sf::RenderTarget &target)
 {
-    // Draw buttons
-    Window::window.draw(debugBtn);
-    Window::window.draw(faceBtn);
-    for (int i = 0; i < NUM_TESTS; ++i)
-        Window::window.draw(testBtns[i]);
+    drawButtons(target);
 
     // Draw tiles
-    for (int i = 0; i < HEIGHT; ++i)
+    for (unsigned int i = 0; i < HEIGHT; ++i)
+        for (unsigned int j = 0; j < WIDTH; ++j)
+            drawTile(target, i, j);
+
+    changedTiles.clear();
+
+    drawFlagCounter(target);
+}
+
+void Board::drawChanges(sf::RenderTarget &target)
+{
+    // Tiles are opaque, so drawing a changed tile fully replaces its previous image
+    for (unsigned int index : changedTiles)
+        drawTile(target, index / WIDTH, index % WIDTH);
+
+    changedTiles.clear();
+
+    // Clear the button bar since the face and flag counter may have changed
+    sf::RectangleShape buttonBar(sf::Vector2f(target.getSize().x, target.getSize().y - HEIGHT * IMAGESIZE));
+    buttonBar.setPosition(0, HEIGHT * IMAGESIZE);
+    buttonBar.setFillColor(sf::Color::White);
+    target.draw(buttonBar);
+
+    drawButtons(target);
+    drawFlagCounter(target);
+}
+
+void Board::drawTile(sf::RenderTarget &target, unsigned int row, unsigned int col)
+{
+    const BoardTile &tile = tiles[row * WIDTH + col];
+    sf::Vector2f position(col * IMAGESIZE, row * IMAGESIZE);
+
+    sf::Sprite &background = tile.isRevealed() ? revealedTile : hiddenTile;
+    background.setPosition(position);
+    target.draw(background);
+
+    // Overlay (mine, number, or flag)
+    sf::Sprite *overlay = nullptr;
+    if (tile.isRevealed() && tile.isMine())
+        overlay = &debugMine;
+    else if (tile.isRevealed() && tile.getAdjacentMineCount() != 0)
+        overlay = &numberOverlays[tile.getAdjacentMineCount() - 1];
+    else if (tile.isFlagged())
+        overlay = &flagOverlay;
+
+    if (overlay)
     {
-        for (int j = 0; j < WIDTH; ++j)
-        {
-            Window::window.draw(tiles[i][j]->getTileSprite());
-            Window::window.draw(tiles[i][j]->getOverlaySprite());
-            if (debugON && tiles[i][j]->isMine())
-            {
-                debugMine.setPosition(j * IMAGESIZE, i * IMAGESIZE);
-                Window::window.draw(debugMine);
-            }
-        }
+        overlay->setPosition(position);
+        target.draw(*overlay);
     }
 
-    drawFlagCounter();
+    if (debugON && tile.isMine())
+    {
+        debugMine.setPosition(position);
+        target.draw(debugMine);
+    }
+}
 
-    if (!debugON)
-        return;
+void Board::drawButtons(sf::RenderTarget &target)
+{
+    target.draw(debugBtn);
+    target.draw(hintBtn);
+    target.draw(faceBtn);
+    for (int i = 0; i < NUM_TESTS; ++i)
+        target.draw(testBtns[i]);
 }
 
-void Board::drawFlagCounter()
+void Board::drawFlagCounter(sf::RenderTarget &target)
 {
     if (faceType == FACE_WIN)
     {
-        drawDigit(0, 0);
-        drawDigit(0, DIGITS_PNG_OFFSET);
+        drawDigit(target, 0, 0);
+        drawDigit(target, 0, DIGITS_PNG_OFFSET);
         return;
     }
 
@@ -292,24 +480,24 @@ void Board::drawFlagCounter()
     // Draw negative sign if there are more flags than mines
     if (mineCount < 0)
     {
-        drawDigit(DIGITS_NEGATIVE_SIGN, xPos);
+        drawDigit(target, DIGITS_NEGATIVE_SIGN, xPos);
         xPos += DIGITS_PNG_OFFSET;
     }
 
     if (hundreds != 0)
     {
-        drawDigit(hundreds, xPos);
+        drawDigit(target, hundreds, xPos);
         xPos += DIGITS_PNG_OFFSET;
     }
 
-    drawDigit(tens, xPos);
+    drawDigit(target, tens, xPos);
     xPos += DIGITS_PNG_OFFSET;
-    drawDigit(ones, xPos);
+    drawDigit(target, ones, xPos);
 }
 
-void Board::drawDigit(int value, int xPos)
+void Board::drawDigit(sf::RenderTarget &target, int value, int xPos)
 {
     digit.setTextureRect(sf::IntRect(DIGITS_PNG_OFFSET * value, 0, DIGITS_PNG_OFFSET, IMAGESIZE));
     digit.setPosition(xPos, HEIGHT * IMAGESIZE);
-    Window::window.draw(digit);
+    target.draw(digit);
 }
\ No newline at end of file
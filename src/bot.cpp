@@ -0,0 +1,227 @@
+#include <sstream>
+
+#include "bot.h"
+#include "parse.h"
+
+/* -------------------------------- BoardView ------------------------------- */
+
+BoardView::BoardView(const Board &board) : board{board} {}
+
+int BoardView::getValue(int row, int col) const
+{
+    const Tile &tile = board.getTile(row, col);
+    if (!tile.isRevealed())
+        return tile.isFlagged() ? FLAGGED : HIDDEN;
+    if (tile.isMine())
+        return MINE;
+    return tile.getAdjacentMineCount();
+}
+
+int BoardView::getFace() const { return board.getFace(); }
+const std::vector<unsigned int> &BoardView::getFrontier() const { return board.getFrontier(); }
+unsigned int BoardView::getUnknownNeighbours(unsigned int index) const { return board.getUnknownNeighbours(index); }
+
+int BoardView::getRemainingMines(unsigned int index) const
+{
+    // The adjacent mine count of a hidden tile is not visible to the player
+    if (!board.getTile(index / Board::WIDTH, index % Board::WIDTH).isRevealed())
+        return 0;
+    return board.getRemainingMines(index);
+}
+
+/* ------------------------------- BotSession ------------------------------- */
+
+BotSession::BotSession(unsigned int mines, std::uint64_t seed) : board{mines, seed}, values(Board::WIDTH * Board::HEIGHT, BoardView::HIDDEN) {}
+
+void BotSession::newGame(unsigned int mines, std::uint64_t seed)
+{
+    board = Board{mines, seed};
+    deltas.clear();
+    values.assign(Board::WIDTH * Board::HEIGHT, BoardView::HIDDEN);
+}
+
+const std::vector<CellDelta> &BotSession::apply(const std::vector<BotCommand> &commands)
+{
+    deltas.clear();
+    board.clearChangedTiles();
+
+    for (const BotCommand &command : commands)
+    {
+        if (board.getFace() != FACE_PLAY)
+            break;
+
+        applyBotCommand(board, command);
+    }
+
+    // Report each touched tile once, and only if its final value differs from the last one reported
+    BoardView view = getView();
+    for (unsigned int index : board.getChangedTiles())
+    {
+        unsigned int row = index / Board::WIDTH;
+        unsigned int col = index % Board::WIDTH;
+        int value = view.getValue(row, col);
+        if (value == values[index])
+            continue;
+
+        values[index] = value;
+        deltas.push_back(CellDelta{row, col, value});
+    }
+
+    board.clearChangedTiles();
+
+    return deltas;
+}
+
+BoardView BotSession::getView() const { return BoardView{board}; }
+std::uint64_t BotSession::getSeed() const { return board.getSeed(); }
+
+/* ------------------------------ Line Protocol ----------------------------- */
+
+void applyBotCommand(Board &board, const BotCommand &command)
+{
+    switch (command.type)
+    {
+    case BotCommand::REVEAL:
+        board.revealTile(command.row, command.col);
+        break;
+    case BotCommand::FLAG:
+        board.flagTile(command.row, command.col);
+        break;
+    case BotCommand::CHORD:
+        board.chordTile(command.row, command.col);
+        break;
+    }
+}
+
+std::string parseBotCommands(const std::string &line, std::vector<BotCommand> &commands)
+{
+    std::istringstream tokens(line);
+    for (std::string action; tokens >> action;)
+    {
+        BotCommand command;
+        if (action == "r")
+            command.type = BotCommand::REVEAL;
+        else if (action == "f")
+            command.type = BotCommand::FLAG;
+        else if (action == "c")
+            command.type = BotCommand::CHORD;
+        else
+            return "unknown command '" + action + "'";
+
+        if (!(tokens >> command.row >> command.col) ||
+            command.row < 0 || command.row >= Board::HEIGHT || command.col < 0 || command.col >= Board::WIDTH)
+            return "command '" + action + "' expects a row and a column on the board";
+
+        commands.push_back(command);
+    }
+
+    return "";
+}
+
+std::string parseBotNewGame(const std::string &line, unsigned int &mines, std::optional<std::uint64_t> &seed)
+{
+    std::istringstream tokens(line);
+    std::string action;
+    std::vector<std::string> args;
+    tokens >> action;
+    for (std::string arg; tokens >> arg;)
+        args.push_back(arg);
+
+    if (action != "n" || args.size() > 2)
+        return "'n' expects at most the number of mines and a seed";
+
+    std::uint64_t values[2]{};
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        std::string error = parseNumber(args[i], values[i]);
+        if (!error.empty())
+            return error;
+    }
+
+    mines = args.empty() ? 50 : values[0];
+    if (!args.empty() && values[0] > Board::WIDTH * Board::HEIGHT)
+        return "too many mines";
+
+    seed.reset();
+    if (args.size() == 2)
+        seed = values[1];
+
+    return "";
+}
+
+void runBotProtocol(std::istream &in, std::ostream &out)
+{
+    BotSession session;
+    std::vector<BotCommand> commands;
+
+    std::string line;
+    while (getline(in, line))
+    {
+        std::istringstream tokens(line);
+        std::string action;
+        if (!(tokens >> action))
+            continue;
+
+        if (action == "q")
+            break;
+
+        if (action == "n")
+        {
+            unsigned int mines;
+            std::optional<std::uint64_t> seed;
+            std::string error = parseBotNewGame(line, mines, seed);
+            if (!error.empty())
+            {
+                out << "error " << error << std::endl;
+                continue;
+            }
+
+            session.newGame(mines, seed.value_or(Random::timeSeed()));
+            out << "play " << session.getSeed() << std::endl;
+            continue;
+        }
+
+        // Parse the whole batch before applying it so malformed batches have no effect
+        commands.clear();
+        std::string error = parseBotCommands(line, commands);
+        if (!error.empty())
+        {
+            out << "error " << error << std::endl;
+            continue;
+        }
+
+        const std::vector<CellDelta> &deltas = session.apply(commands);
+
+        switch (session.getView().getFace())
+        {
+        case FACE_WIN:
+            out << "win";
+            break;
+        case FACE_LOSE:
+            out << "lose";
+            break;
+        default:
+            out << "play";
+        }
+
+        for (const CellDelta &delta : deltas)
+        {
+            out << ' ' << delta.row << ',' << delta.col << ',';
+            switch (delta.value)
+            {
+            case BoardView::HIDDEN:
+                out << 'H';
+                break;
+            case BoardView::FLAGGED:
+                out << 'F';
+                break;
+            case BoardView::MINE:
+                out << 'M';
+                break;
+            default:
+                out << delta.value;
+            }
+        }
+        out << std::endl;
+    }
+}
@@ -0,0 +1,235 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "exporter.h"
+#include "bot.h"
+#include "parse.h"
+
+/* ------------------------------ Constructors ------------------------------ */
+
+FrameExporter::FrameExporter(const std::string &directory, const std::string &extension, unsigned int encoders,
+                             unsigned int period)
+    : directory{directory}, extension{extension}, frameCount{0}, period{std::max(1u, period)}, movesDrawn{0},
+      finished{false}, failures{0}
+{
+    if (!target.create(Window::WIDTH, Window::HEIGHT))
+        throw std::runtime_error("ERROR: Failed to create the off-screen render target.");
+
+    for (unsigned int i = 0; i < std::max(1u, encoders); ++i)
+        this->encoders.emplace_back(&FrameExporter::encode, this);
+}
+
+FrameExporter::~FrameExporter() { finish(); }
+
+/* -------------------------------- Accessors ------------------------------- */
+
+unsigned int FrameExporter::getFrameCount() const { return frameCount; }
+
+/* -------------------------------- Mutators -------------------------------- */
+
+void FrameExporter::captureFull(Board &board)
+{
+    queueDrawnMoves();
+
+    target.clear(sf::Color::White);
+    board.drawUpdates(target);
+    queueFrame();
+}
+
+void FrameExporter::captureChanges(Board &board)
+{
+    if (board.getChangedTiles().empty())
+        return;
+
+    // Every move is drawn so the target stays in sync, but only every `period` moves is read back and encoded
+    board.drawChanges(target);
+    if (++movesDrawn >= period)
+        queueFrame();
+}
+
+unsigned int FrameExporter::finish()
+{
+    queueDrawnMoves();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+    queued.notify_all();
+
+    for (std::thread &encoder : encoders)
+        encoder.join();
+    encoders.clear();
+
+    return failures;
+}
+
+// Private Helper Mutators
+
+void FrameExporter::queueFrame()
+{
+    movesDrawn = 0;
+    target.display();
+    Frame frame{frameCount++, std::make_unique<sf::Image>(target.getTexture().copyToImage())};
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        dequeued.wait(lock, [this] { return frames.size() < MAX_QUEUED_FRAMES; });
+        frames.push_back(std::move(frame));
+    }
+    queued.notify_one();
+}
+
+void FrameExporter::queueDrawnMoves()
+{
+    if (movesDrawn != 0)
+        queueFrame();
+}
+
+void FrameExporter::encode()
+{
+    while (true)
+    {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queued.wait(lock, [this] { return finished || !frames.empty(); });
+            if (frames.empty())
+                return;
+
+            frame = std::move(frames.front());
+            frames.pop_front();
+        }
+        dequeued.notify_one();
+
+        std::ostringstream path;
+        path << directory << "/frame_" << std::setw(6) << std::setfill('0') << frame.number << '.' << extension;
+        if (!frame.image->saveToFile(path.str()))
+            ++failures;
+    }
+}
+
+/* ------------------------------- Export Mode ------------------------------ */
+
+int runExport(const std::vector<std::string> &args)
+{
+    static constexpr unsigned int MAX_ENCODERS = 256; // Most encoder threads accepted by `--encoders`
+
+    std::vector<std::string> paths;
+    std::string extension = "png";
+    unsigned int encoders = std::min(MAX_ENCODERS, std::max(2u, std::thread::hardware_concurrency()) - 1);
+    unsigned int period = 1;
+
+    std::string error;
+    for (size_t i = 0; i < args.size() && error.empty(); ++i)
+    {
+        bool hasValue = i + 1 < args.size();
+        std::uint64_t value = 0;
+        if (args[i] == "--format" && hasValue)
+            extension = args[++i];
+        else if (args[i] == "--encoders" && hasValue)
+        {
+            error = parseNumber(args[++i], value, MAX_ENCODERS);
+            encoders = value;
+            if (error.empty() && encoders == 0)
+                error = "'--encoders' expects at least one encoder";
+        }
+        else if (args[i] == "--every" && hasValue)
+        {
+            error = parseNumber(args[++i], value, std::numeric_limits<unsigned int>::max());
+            period = value;
+            if (error.empty() && period == 0)
+                error = "'--every' expects at least one move";
+        }
+        else if (args[i].rfind("--", 0) == 0)
+            error = "unknown option '" + args[i] + "'";
+        else
+            paths.push_back(args[i]);
+    }
+
+    if (error.empty() && paths.size() != 2)
+        error = "expected a replay file and an output directory";
+    else if (error.empty() && extension != "png" && extension != "bmp" && extension != "tga" && extension != "jpg")
+        error = "unsupported format '" + extension + "'";
+
+    if (!error.empty())
+    {
+        std::cerr << "ERROR: " << error << std::endl;
+        return 1;
+    }
+
+    std::ifstream replay(paths[0]);
+    if (!replay.is_open())
+    {
+        std::cerr << "ERROR: The file " << paths[0] << " could not be opened." << std::endl;
+        return 1;
+    }
+
+    // The exporter creates the OpenGL context, so it must exist before any board loads its textures
+    FrameExporter exporter(paths[1], extension, encoders, period);
+    std::unique_ptr<Board> board;
+    std::vector<BotCommand> commands;
+
+    std::string line;
+    for (unsigned int lineNumber = 1; getline(replay, line); ++lineNumber)
+    {
+        std::istringstream tokens(line);
+        std::string action;
+        if (!(tokens >> action))
+            continue;
+
+        if (action == "q")
+            break;
+
+        std::string error;
+        if (action == "n")
+        {
+            unsigned int mines;
+            std::optional<std::uint64_t> seed;
+            error = parseBotNewGame(line, mines, seed);
+            if (error.empty() && !seed)
+                error = "'n' expects the number of mines and the seed so the game can be replayed";
+            else if (error.empty())
+            {
+                board = std::make_unique<Board>(mines, *seed);
+                exporter.captureFull(*board);
+                continue;
+            }
+        }
+        else if (!board)
+            error = "the replay must start with an 'n' line";
+        else
+        {
+            commands.clear();
+            error = parseBotCommands(line, commands);
+        }
+
+        if (!error.empty())
+        {
+            std::cerr << "ERROR: " << paths[0] << ":" << lineNumber << ": " << error << std::endl;
+            return 1;
+        }
+
+        // One drawn move per command that changed the board
+        for (const BotCommand &command : commands)
+        {
+            if (board->getFace() != FACE_PLAY)
+                break;
+
+            applyBotCommand(*board, command);
+            exporter.captureChanges(*board);
+        }
+    }
+
+    unsigned int failures = exporter.finish();
+    if (failures != 0)
+    {
+        std::cerr << "ERROR: " << failures << " frames could not be written to " << paths[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << exporter.getFrameCount() << " frames to " << paths[1] << std::endl;
+    return 0;
+}
@@ -0,0 +1,408 @@
+#include <algorithm>
+#include <cmath>
+
+#include "hints.h"
+#include "bot.h"
+
+/* --------------------------------- Helpers -------------------------------- */
+
+/// @brief Write the indices of the tiles adjacent to `index` into `adjacent`.
+/// @return The number of adjacent tiles.
+static int getAdjacent(unsigned int index, unsigned int adjacent[8])
+{
+    const int row[]{-1, -1, -1, 1, 1, 1, 0, 0};
+    const int col[]{-1, 0, 1, -1, 0, 1, -1, 1};
+
+    int x = index / Board::WIDTH;
+    int y = index % Board::WIDTH;
+    int count = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        if (x + row[i] >= 0 && x + row[i] < Board::HEIGHT && y + col[i] >= 0 && y + col[i] < Board::WIDTH)
+            adjacent[count++] = (x + row[i]) * Board::WIDTH + (y + col[i]);
+    }
+
+    return count;
+}
+
+/// @return The natural logarithm of `n` choose `k`.
+static double logChoose(int n, int k) { return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0); }
+
+/// @return The distribution of the total of two independent mine counts with distributions `a` and `b`.
+static std::vector<double> convolve(const std::vector<double> &a, const std::vector<double> &b)
+{
+    std::vector<double> result(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); ++i)
+        for (size_t j = 0; j < b.size(); ++j)
+            result[i + j] += a[i] * b[j];
+    return result;
+}
+
+/// @brief Placement counts of one solved frontier component.
+struct Component
+{
+    std::vector<unsigned int> cells;                // Hidden tiles of the component
+    std::vector<double> solutions;                  // Relative number of placements by total mines
+    std::vector<std::vector<double>> cellSolutions; // Relative number of placements with the cell a mine, by total mines
+};
+
+/// @brief Enumerates every mine placement of one frontier component that satisfies its numbers.
+struct ComponentSolver
+{
+    std::vector<int> targets;                       // Unflagged mines around each number
+    std::vector<int> placed;                        // Mines placed so far around each number
+    std::vector<int> open;                          // Cells not yet assigned around each number
+    std::vector<std::vector<int>> cellConstraints;  // Numbers bordering each cell
+    std::vector<char> assignment;                   // Current placement (1 = mine) of each cell
+    std::vector<double> solutions;                  // Number of placements by total mines
+    std::vector<std::vector<double>> cellSolutions; // Number of placements with the cell a mine, by total mines
+    int maxMines;                                   // Most mines a placement may use
+    long steps = 0;                                 // Search steps taken so far
+    bool aborted = false;                           // Search gave up or was cancelled
+
+    /// @brief Assign `cell` and every cell after it, given `mines` already placed.
+    template <typename Cancelled>
+    void search(size_t cell, int mines, const Cancelled &cancelled)
+    {
+        if (aborted)
+            return;
+        if (++steps % 4096 == 0 && (steps > Hints::MAX_SOLVER_STEPS || cancelled()))
+        {
+            aborted = true;
+            return;
+        }
+
+        if (cell == assignment.size())
+        {
+            solutions[mines] += 1;
+            for (size_t i = 0; i < assignment.size(); ++i)
+            {
+                if (assignment[i])
+                    cellSolutions[i][mines] += 1;
+            }
+            return;
+        }
+
+        for (int mine = 0; mine <= 1; ++mine)
+        {
+            if (mines + mine > maxMines)
+                break;
+
+            bool valid = true;
+            for (int number : cellConstraints[cell])
+            {
+                placed[number] += mine;
+                --open[number];
+                if (placed[number] > targets[number] || placed[number] + open[number] < targets[number])
+                    valid = false;
+            }
+
+            if (valid)
+            {
+                assignment[cell] = mine;
+                search(cell + 1, mines + mine, cancelled);
+            }
+
+            for (int number : cellConstraints[cell])
+            {
+                placed[number] -= mine;
+                ++open[number];
+            }
+        }
+    }
+};
+
+/* ------------------------------ Constructors ------------------------------ */
+
+Hints::Hints()
+    : visibleVersion{0}, generation{0}, stopping{false},
+      shade{sf::Vector2f(IMAGESIZE, IMAGESIZE)}
+{
+    worker = std::thread(&Hints::work, this);
+}
+
+Hints::~Hints()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        ++generation;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+/* -------------------------------- Mutators -------------------------------- */
+
+void Hints::update(const Board &board)
+{
+    // Cancel the current computation and start over on a snapshot of the new state.
+    // Only reveals and flags change the version, so unchanged frames never read the board.
+    if (board.getVersion() != visibleVersion)
+    {
+        visibleVersion = board.getVersion();
+
+        BoardView view(board);
+        std::vector<int> values(Board::WIDTH * Board::HEIGHT);
+        for (unsigned int i = 0; i < values.size(); ++i)
+            values[i] = view.getValue(i / Board::WIDTH, i % Board::WIDTH);
+        probabilities.assign(values.size(), -1.0f);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = Snapshot{++generation, std::move(values), board.getFrontier(), board.getMinesLeft()};
+            results.clear();
+        }
+        wake.notify_one();
+    }
+
+    // Apply finished results within the frame budget
+    sf::Clock clock;
+    while (clock.getElapsedTime().asMicroseconds() < FRAME_BUDGET_US)
+    {
+        Result result;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (results.empty())
+                break;
+            result = std::move(results.front());
+            results.pop_front();
+        }
+
+        if (result.generation != generation)
+            continue;
+
+        for (const auto &[index, probability] : result.probabilities)
+            probabilities[index] = probability;
+    }
+}
+
+// Private Helper Mutators
+
+void Hints::work()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this] { return stopping || pending.has_value(); });
+        if (stopping)
+            return;
+
+        Snapshot snapshot = std::move(*pending);
+        pending.reset();
+
+        lock.unlock();
+        solve(snapshot);
+        lock.lock();
+    }
+}
+
+void Hints::solve(const Snapshot &snapshot)
+{
+    const std::vector<int> &values = snapshot.values;
+    const unsigned int tileCount = values.size();
+    if (snapshot.minesLeft < 0)
+        return;
+
+    int unknownCount = std::count(values.begin(), values.end(), BoardView::HIDDEN);
+
+    std::vector<char> isFrontier(tileCount, false);
+    for (unsigned int index : snapshot.frontier)
+        isFrontier[index] = true;
+
+    std::vector<char> visited(tileCount, false); // Numbers already added to a component
+    std::vector<int> cellSlot(tileCount, -1);    // Position of each hidden tile in its component
+
+    unsigned int adjacent[8];
+    unsigned int adjacentToCell[8];
+    std::vector<Component> components;
+    int constrainedCells = 0;
+
+    // Split the frontier into components of numbers that share hidden tiles and solve each one
+    for (unsigned int start : snapshot.frontier)
+    {
+        if (visited[start])
+            continue;
+
+        std::vector<unsigned int> numbers;
+        std::vector<unsigned int> cells;
+        std::vector<unsigned int> queue{start};
+        visited[start] = true;
+
+        while (!queue.empty())
+        {
+            unsigned int number = queue.back();
+            queue.pop_back();
+            numbers.push_back(number);
+
+            int count = getAdjacent(number, adjacent);
+            for (int i = 0; i < count; ++i)
+            {
+                if (values[adjacent[i]] != BoardView::HIDDEN || cellSlot[adjacent[i]] >= 0)
+                    continue;
+
+                cellSlot[adjacent[i]] = cells.size();
+                cells.push_back(adjacent[i]);
+
+                int cellCount = getAdjacent(adjacent[i], adjacentToCell);
+                for (int j = 0; j < cellCount; ++j)
+                {
+                    if (isFrontier[adjacentToCell[j]] && !visited[adjacentToCell[j]])
+                    {
+                        visited[adjacentToCell[j]] = true;
+                        queue.push_back(adjacentToCell[j]);
+                    }
+                }
+            }
+        }
+
+        ComponentSolver solver;
+        solver.maxMines = std::min<int>(cells.size(), snapshot.minesLeft);
+        solver.targets.resize(numbers.size());
+        solver.placed.assign(numbers.size(), 0);
+        solver.open.assign(numbers.size(), 0);
+        solver.cellConstraints.resize(cells.size());
+        solver.assignment.assign(cells.size(), 0);
+        solver.solutions.assign(solver.maxMines + 1, 0);
+        solver.cellSolutions.assign(cells.size(), std::vector<double>(solver.maxMines + 1, 0));
+
+        for (unsigned int i = 0; i < numbers.size(); ++i)
+        {
+            solver.targets[i] = values[numbers[i]];
+            int count = getAdjacent(numbers[i], adjacent);
+            for (int j = 0; j < count; ++j)
+            {
+                if (values[adjacent[j]] == BoardView::FLAGGED)
+                    --solver.targets[i];
+                else if (values[adjacent[j]] == BoardView::HIDDEN)
+                {
+                    solver.cellConstraints[cellSlot[adjacent[j]]].push_back(i);
+                    ++solver.open[i];
+                }
+            }
+        }
+
+        solver.search(0, 0, [&] { return cancelled(snapshot.generation); });
+        if (cancelled(snapshot.generation))
+            return;
+        // Without every component's distribution the probabilities cannot be combined exactly
+        if (solver.aborted)
+            return;
+
+        // Scaling a component's counts does not change any probability; it keeps large counts in range
+        double largest = *std::max_element(solver.solutions.begin(), solver.solutions.end());
+        if (largest == 0) // No placement fits: the flags around this component are wrong
+            return;
+        for (double &count : solver.solutions)
+            count /= largest;
+        for (std::vector<double> &counts : solver.cellSolutions)
+            for (double &count : counts)
+                count /= largest;
+
+        constrainedCells += cells.size();
+        components.push_back(Component{std::move(cells), std::move(solver.solutions), std::move(solver.cellSolutions)});
+    }
+
+
+    // Weight every combination of component mine counts by the ways to place the rest of the mines
+    // on the unconstrained tiles: C(interior, minesLeft - frontier mines)
+    int interior = unknownCount - constrainedCells;
+    std::vector<std::vector<double>> prefixes{{1.0}}; // Mine count distribution of components [0, i)
+    for (const Component &component : components)
+        prefixes.push_back(convolve(prefixes.back(), component.solutions));
+    std::vector<std::vector<double>> suffixes{{1.0}}; // Mine count distribution of components [i, end), reversed
+    for (auto component = components.rbegin(); component != components.rend(); ++component)
+        suffixes.push_back(convolve(suffixes.back(), component->solutions));
+
+    const std::vector<double> &frontierMines = prefixes.back();
+    std::vector<double> weights(frontierMines.size(), 0);
+    double maxLogWeight = -INFINITY;
+    for (int mines = 0; mines < (int)weights.size(); ++mines)
+    {
+        int others = snapshot.minesLeft - mines;
+        if (others >= 0 && others <= interior && frontierMines[mines] > 0)
+            maxLogWeight = std::max(maxLogWeight, logChoose(interior, others));
+    }
+
+    double total = 0;
+    double interiorMines = 0;
+    for (int mines = 0; mines < (int)weights.size(); ++mines)
+    {
+        int others = snapshot.minesLeft - mines;
+        if (others >= 0 && others <= interior && frontierMines[mines] > 0)
+            weights[mines] = std::exp(logChoose(interior, others) - maxLogWeight);
+        total += frontierMines[mines] * weights[mines];
+        interiorMines += frontierMines[mines] * weights[mines] * std::max(others, 0);
+    }
+
+    // No combination fits the mines left: the flags are wrong
+    if (total == 0)
+        return;
+
+    for (unsigned int i = 0; i < components.size(); ++i)
+    {
+        if (cancelled(snapshot.generation))
+            return;
+
+        // Weight of each mine count of this component, summed over the mine counts of all the others
+        const Component &component = components[i];
+        std::vector<double> others = convolve(prefixes[i], suffixes[components.size() - 1 - i]);
+        std::vector<double> countWeights(component.solutions.size(), 0);
+        for (unsigned int mines = 0; mines < countWeights.size(); ++mines)
+            for (unsigned int otherMines = 0; otherMines < others.size() && mines + otherMines < weights.size(); ++otherMines)
+                countWeights[mines] += others[otherMines] * weights[mines + otherMines];
+
+        Result result{snapshot.generation, {}};
+        for (unsigned int j = 0; j < component.cells.size(); ++j)
+        {
+            double mineWeight = 0;
+            for (unsigned int mines = 0; mines < countWeights.size(); ++mines)
+                mineWeight += component.cellSolutions[j][mines] * countWeights[mines];
+
+            result.probabilities.emplace_back(component.cells[j], mineWeight / total);
+        }
+        publish(std::move(result));
+    }
+
+    // The unconstrained tiles share the expected number of mines left off the frontier
+    if (interior == 0)
+        return;
+
+    float probability = interiorMines / total / interior;
+    Result result{snapshot.generation, {}};
+    for (unsigned int i = 0; i < tileCount; ++i)
+    {
+        if (values[i] == BoardView::HIDDEN && cellSlot[i] < 0)
+            result.probabilities.emplace_back(i, probability);
+    }
+    publish(std::move(result));
+}
+
+void Hints::publish(Result &&result)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (result.generation == generation)
+        results.push_back(std::move(result));
+}
+
+bool Hints::cancelled(unsigned int snapshotGeneration) const { return generation != snapshotGeneration; }
+
+/* --------------------------------- Display -------------------------------- */
+
+void Hints::draw()
+{
+    for (unsigned int i = 0; i < probabilities.size(); ++i)
+    {
+        if (probabilities[i] < 0)
+            continue;
+
+        // Safe tiles are green; the rest get redder as the mine probability rises
+        if (probabilities[i] == 0)
+            shade.setFillColor(sf::Color(0, 200, 0, 120));
+        else
+            shade.setFillColor(sf::Color(255, 0, 0, 40 + probabilities[i] * 160));
+
+        shade.setPosition((i % Board::WIDTH) * IMAGESIZE, (i / Board::WIDTH) * IMAGESIZE);
+        Window::window.draw(shade);
+    }
+}
@@ -1,9 +1,27 @@
+#include <iostream>
+
 #include "minesweeper.h"
 
 // TODO: Run valgrind on this and check for leaks
 
-int main()
+int main(int argc, char *argv[])
 {
+    // Headless mode for automated players (see bot.h for the protocol)
+    if (argc > 1 && std::string(argv[1]) == BOT_ARG)
+    {
+        Textures::setHeadless(true);
+        runBotProtocol(std::cin, std::cout);
+        return 0;
+    }
+
+    // Batch board analytics (see analytics.h for the arguments)
+    if (argc > 1 && std::string(argv[1]) == ANALYZE_ARG)
+        return runAnalytics(std::vector<std::string>(argv + 2, argv + argc), std::cout);
+
+    // Off-screen replay export (see exporter.h for the arguments)
+    if (argc > 1 && std::string(argv[1]) == EXPORT_ARG)
+        return runExport(std::vector<std::string>(argv + 2, argv + argc));
+
     Window::initializeWindow();
 
     runGame();
@@ -16,6 +34,7 @@ int main()
 void runGame()
 {
     Board board = Board{};
+    Hints hints;
 
     while (Window::window.isOpen())
     {
@@ -25,6 +44,12 @@ void runGame()
 
         board.drawUpdates();
 
+        if (board.isHintOn())
+        {
+            hints.update(board);
+            hints.draw();
+        }
+
         Window::window.display();
     }
 }
@@ -97,6 +122,12 @@ void leftClick(const sf::Vector2f &mousePos, Board &board)
         board.toggleDebug();
     }
 
+    // Hint clicked
+    else if (board.getFace() == FACE_PLAY && mouseOverSprite(mousePos, board.getHintButton()))
+    {
+        board.toggleHint();
+    }
+
     // Test clicked
     else
     {
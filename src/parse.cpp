@@ -0,0 +1,26 @@
+#include <stdexcept>
+
+#include "parse.h"
+
+std::string parseNumber(const std::string &text, std::uint64_t &value, std::uint64_t max)
+{
+    // Only plain digits are accepted so that signs and trailing characters are rejected
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos)
+        return "'" + text + "' is not a non-negative number";
+
+    std::uint64_t number;
+    try
+    {
+        number = std::stoull(text);
+    }
+    catch (const std::out_of_range &)
+    {
+        return "'" + text + "' is too large";
+    }
+
+    if (number > max)
+        return "'" + text + "' is too large (at most " + std::to_string(max) + ")";
+
+    value = number;
+    return "";
+}
@@ -1,7 +1,53 @@
-#include <ctime>
+#include <atomic>
+#include <chrono>
 
 #include "random.h"
 
-std::mt19937 Random::random(std::time(nullptr));
+static constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull; // SplitMix64 counter increment
 
-std::mt19937 &Random::getGenerator() { return random; }
\ No newline at end of file
+/* ------------------------------ Constructors ------------------------------ */
+
+Random::Random(std::uint64_t seed, std::uint64_t game, std::uint64_t stream)
+    : key{mix(mix(mix(seed) + game) + stream)}, counter{0} {}
+
+/* -------------------------------- Accessors ------------------------------- */
+
+std::uint64_t Random::timeSeed()
+{
+    static std::atomic<std::uint64_t> calls{0};
+    std::uint64_t now = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return mix(now + ++calls * GOLDEN_GAMMA);
+}
+
+/* -------------------------------- Mutators -------------------------------- */
+
+Random::result_type Random::operator()() { return mix(key + ++counter * GOLDEN_GAMMA); }
+
+std::uint32_t Random::uniform(std::uint32_t bound)
+{
+    // Lemire's multiply-shift: rejection is only needed for the few values that would bias the result
+    std::uint64_t product = ((*this)() >> 32) * bound;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < bound)
+    {
+        std::uint32_t threshold = -bound % bound;
+        while (low < threshold)
+        {
+            product = ((*this)() >> 32) * bound;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+
+    return product >> 32;
+}
+
+void Random::discard(std::uint64_t count) { counter += count; }
+
+// Private Helper Accessor
+
+std::uint64_t Random::mix(std::uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
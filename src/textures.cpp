@@ -1,6 +1,7 @@
 #include "textures.h"
 
 std::unordered_map<std::string, std::shared_ptr<sf::Texture>> Textures::textures;
+bool Textures::headless = false;
 
 std::shared_ptr<sf::Texture> Textures::getTexture(const std::string &name)
 {
@@ -10,8 +11,16 @@ std::shared_ptr<sf::Texture> Textures::getTexture(const std::string &name)
     return Textures::textures[name];
 }
 
+void Textures::setHeadless(bool enabled) { headless = enabled; }
+
 void Textures::loadTexture(const std::string &file)
 {
+    if (headless)
+    {
+        textures[file] = std::make_shared<sf::Texture>();
+        return;
+    }
+
     auto texture = std::make_shared<sf::Texture>();
     if (!texture->loadFromFile(file))
         throw std::runtime_error("ERROR: Failed to load texture from file: " + file);